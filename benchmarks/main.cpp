@@ -2,9 +2,14 @@
 #include <thread>
 #include <atomic>
 #include <random>
+#include <memory>
+#include <string>
 #include "../include/OrderBook.hpp"
 #include "../include/OrderQueue.hpp"
-#include "../include/Order.hpp"
+#include "../include/order.hpp"
+#include "../include/Affinity.hpp"
+#include "../include/Dashboard.hpp"
+#include <fcntl.h>
 
 // Benchmark 1: Measure raw insertion speed of a Sell Limit Order
 static void BM_AddLimitOrder(benchmark::State& state) {
@@ -91,9 +96,222 @@ static void BM_MultiThreadedThroughput(benchmark::State& state) {
     }
 }
 
+// Benchmark 4: Clearing-price kernel alone (depth curves + max-volume search)
+static void BM_AuctionClearingKernel(benchmark::State& state) {
+    const size_t levels = state.range(0);
+    AuctionLadder ladder;
+    ladder.reset(levels);
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> qtyDist(1, 100);
+    // Bids on the upper 60% of the ladder, asks on the lower 60% (crossed middle)
+    for (size_t i = 0; i < levels; ++i) {
+        if (i >= levels * 4 / 10) ladder.addBid(i, qtyDist(gen));
+        if (i < levels * 6 / 10) ladder.addAsk(i, qtyDist(gen));
+    }
+
+    for (auto _ : state) {
+        auto level = ladder.findClearingLevel(0, 0);
+        benchmark::DoNotOptimize(level);
+    }
+    state.SetItemsProcessed(state.iterations() * levels);
+}
+
+// Benchmark 5: Full uncross of a crossed auction book (10,000 price levels)
+// Building and destroying the book happen with the timer paused.
+static void BM_AuctionUncross(benchmark::State& state) {
+    const int levels = state.range(0);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto book = std::make_unique<OrderBook>();
+        book->setMatchingMode(MatchingMode::AUCTION);
+        int id = 0;
+        for (int i = 0; i < levels; ++i) {
+            double price = 100.0 + i * 0.01;
+            if (i >= levels * 4 / 10) book->addOrder(Order(id++, Side::BUY, OrderType::LIMIT, price, 10));
+            if (i < levels * 6 / 10) book->addOrder(Order(id++, Side::SELL, OrderType::LIMIT, price, 10));
+        }
+        state.ResumeTiming();
+
+        auto result = book->uncross(0.01);
+        benchmark::DoNotOptimize(result);
+
+        state.PauseTiming();
+        book.reset();
+        state.ResumeTiming();
+    }
+}
+
+// Benchmark 6: Queue hand-off latency, cv.wait wakeup (0) vs busy-poll (1)
+// The producer paces orders so the consumer goes idle between them, which is
+// exactly when a sleeping consumer pays the scheduler wakeup.
+// With a single CPU both threads share it; busy-poll still runs (labelled
+// "shared core") to show what it costs without a dedicated core.
+static void BM_QueueHandoffLatency(benchmark::State& state) {
+    const bool busyPoll = state.range(0) == 1;
+    const int ordersPerRun = 2000;
+    const auto gap = std::chrono::microseconds(20);
+    const bool multiCore = std::thread::hardware_concurrency() >= 2;
+    std::vector<long long> samples;
+    samples.reserve(ordersPerRun * 64);
+
+    for (auto _ : state) {
+        OrderBook book;
+        OrderQueue orderQueue;
+
+        std::thread consumer([&]() {
+            if (multiCore) pinCurrentThread(1);
+            Order order(0, Side::BUY, OrderType::LIMIT, 0, 0);
+            OrderQueue::TimePoint enqueuedAt;
+            while (true) {
+                if (busyPoll) {
+                    PollResult polled = orderQueue.poll(order, enqueuedAt);
+                    if (polled == PollResult::DONE) break;
+                    if (polled == PollResult::EMPTY) {
+                        cpuRelax();
+                        continue;
+                    }
+                } else if (!orderQueue.pop(order, enqueuedAt)) {
+                    break;
+                }
+                samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - enqueuedAt).count());
+                book.addOrder(std::move(order));
+            }
+        });
+
+        // Producer gets its own pinned thread so the benchmark's main thread keeps its affinity
+        std::thread producer([&]() {
+            if (multiCore) pinCurrentThread(0);
+            for (int i = 0; i < ordersPerRun; ++i) {
+                Side side = (i % 2 == 0) ? Side::BUY : Side::SELL;
+                orderQueue.push(Order(i, side, OrderType::LIMIT, 100.0 + (i % 5), 10));
+                auto until = std::chrono::steady_clock::now() + gap;
+                while (std::chrono::steady_clock::now() < until) cpuRelax();
+            }
+            orderQueue.stop();
+        });
+        producer.join();
+        consumer.join();
+    }
+
+    std::sort(samples.begin(), samples.end());
+    if (!samples.empty()) {
+        state.counters["p50_ns"] = samples[samples.size() / 2];
+        state.counters["p99_ns"] = samples[(size_t)(samples.size() * 0.99)];
+        state.counters["p999_ns"] = samples[(size_t)(samples.size() * 0.999)];
+        state.counters["max_ns"] = samples.back();
+    }
+    std::string label = busyPoll ? "busy-poll" : "cv.wait";
+    state.SetLabel(multiCore ? label : label + ", shared core");
+}
+
+// Benchmark 7: Matcher latency with the dashboard off (0) or rendering at N Hz
+// Orders are fed for a fixed wall-clock window (enough for hundreds of frames at
+// 240 Hz) with the renderer running the whole time. Frames go to /dev/null so only
+// the rendering pipeline itself is measured.
+static void BM_MatcherWithDashboard(benchmark::State& state) {
+    const int refreshHz = state.range(0);
+    const auto window = std::chrono::seconds(1);
+    std::vector<long long> samples;
+    samples.reserve(1 << 22);
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<> sideDist(0, 1);
+    std::uniform_int_distribution<> priceDist(95, 105);
+    std::uniform_int_distribution<> qtyDist(10, 50);
+    long long framesInWindow = 0;
+
+    for (auto _ : state) {
+        OrderBook book;
+        std::atomic<bool> running{true};
+        std::atomic<long long> frames{0};
+        std::thread display;
+        if (refreshHz > 0) {
+            book.subscribeAnalytics(); // Before the window: the matcher publishes for the whole run
+            display = std::thread([&]() {
+                int devNull = open("/dev/null", O_WRONLY);
+                DashboardRenderer renderer;
+                const auto period = std::chrono::microseconds(1000000 / refreshHz);
+                auto nextFrame = std::chrono::steady_clock::now();
+                while (running) {
+                    renderer.render(book.getAnalytics(), {0, 0.0, book.getPendingStopOrders()});
+                    renderer.flush(devNull);
+                    frames.fetch_add(1, std::memory_order_relaxed);
+                    nextFrame += period;
+                    std::this_thread::sleep_until(nextFrame);
+                }
+                close(devNull);
+            });
+        }
+
+        long long firstFrame = frames.load();
+        auto windowEnd = std::chrono::steady_clock::now() + window;
+        for (int i = 0; ; ++i) {
+            Side side = (sideDist(gen) == 0) ? Side::BUY : Side::SELL;
+            Order order(i, side, OrderType::LIMIT, (double)priceDist(gen), qtyDist(gen));
+            auto start = std::chrono::steady_clock::now();
+            book.addOrder(std::move(order));
+            auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            if (end >= windowEnd) break;
+        }
+        framesInWindow = frames.load() - firstFrame;
+
+        state.PauseTiming(); // Joining waits out the display thread's current frame period
+        running = false;
+        if (display.joinable()) display.join();
+        state.ResumeTiming();
+    }
+
+    std::sort(samples.begin(), samples.end());
+    if (!samples.empty()) {
+        state.counters["orders"] = samples.size();
+        state.counters["frames"] = framesInWindow;
+        state.counters["p50_ns"] = samples[samples.size() / 2];
+        state.counters["p99_ns"] = samples[(size_t)(samples.size() * 0.99)];
+        state.counters["p999_ns"] = samples[(size_t)(samples.size() * 0.999)];
+    }
+    state.SetLabel(refreshHz > 0 ? "dashboard on" : "dashboard off");
+}
+
+// Benchmark 8: Cost of formatting one dashboard frame
+static void BM_RenderFrame(benchmark::State& state) {
+    OrderBook book;
+    for (int i = 0; i < 1000; ++i) {
+        book.addOrder(Order(i, (i % 2) ? Side::BUY : Side::SELL, OrderType::LIMIT, 95.0 + (i % 11), 10 + i % 40));
+    }
+    book.subscribeAnalytics();
+    DashboardRenderer renderer;
+    for (auto _ : state) {
+        AnalyticsSnapshot snap = book.getAnalytics();
+        benchmark::DoNotOptimize(renderer.render(snap, {1234, 7.0, 3}));
+    }
+}
+
+// Benchmark 9: Steady-state fills (BM_MatchOrder drains its liquidity after ~20k
+// iterations and then mostly times market orders against an empty book)
+// Each iteration rests one sell and fills it with a market buy: 2 events, 1 fill.
+static void BM_FillCycle(benchmark::State& state) {
+    OrderBook book;
+    for (int i = 0; i < 100; ++i) {
+        book.addOrder(Order(i, Side::BUY, OrderType::LIMIT, 90.0 + (i % 5), 10));
+    }
+    int id = 1000;
+    for (auto _ : state) {
+        double price = 100.0 + (id % 3);
+        book.addOrder(Order(id++, Side::SELL, OrderType::LIMIT, price, 10));
+        book.addOrder(Order(id++, Side::BUY, OrderType::MARKET, 0.0, 10));
+    }
+}
+
 // Register the functions
 BENCHMARK(BM_AddLimitOrder);
 BENCHMARK(BM_MatchOrder);
 BENCHMARK(BM_MultiThreadedThroughput)->DenseRange(1, 4)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AuctionClearingKernel)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_AuctionUncross)->Arg(10000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_QueueHandoffLatency)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_MatcherWithDashboard)->Arg(0)->Arg(60)->Arg(240)->Iterations(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_RenderFrame);
+BENCHMARK(BM_FillCycle);
 
 BENCHMARK_MAIN();
\ No newline at end of file
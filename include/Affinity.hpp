@@ -0,0 +1,64 @@
+#ifndef AFFINITY_HPP
+#define AFFINITY_HPP
+
+#include <pthread.h>
+#include <sched.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#ifdef HAVE_LIBNUMA
+#include <numa.h>
+#endif
+
+using namespace std;
+
+// Pins the calling thread to one CPU. Returns false if the OS refused.
+inline bool pinCurrentThread(int cpu) {
+    if (cpu < 0) return true;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+// SCHED_FIFO for the calling thread (needs CAP_SYS_NICE / root)
+inline bool setRealtimePriority(int priority) {
+    if (priority <= 0) return true;
+    sched_param param{};
+    param.sched_priority = priority;
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+}
+
+inline int numaNodeOfCpu(int cpu) {
+#ifdef HAVE_LIBNUMA
+    if (cpu >= 0 && numa_available() >= 0) return numa_node_of_cpu(cpu);
+#else
+    (void)cpu;
+#endif
+    return -1;
+}
+
+// Prefer 'node' for every later allocation made by the calling thread.
+// Without libnuma, pinning alone still gives node-local memory through the
+// kernel's first-touch policy, as long as the pinned thread allocates it.
+inline bool preferNumaNode(int node) {
+    if (node < 0) return true;
+#ifdef HAVE_LIBNUMA
+    if (numa_available() < 0) return false;
+    numa_set_preferred(node);
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Spin-wait hint (lets the sibling hyperthread run, saves power)
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+#endif
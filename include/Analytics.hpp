@@ -0,0 +1,245 @@
+#ifndef ANALYTICS_HPP
+#define ANALYTICS_HPP
+
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include "order.hpp"
+#include "SeqLock.hpp"
+
+using namespace std;
+
+// Sliding windows cover the last ANALYTICS_WINDOW trades
+constexpr size_t ANALYTICS_WINDOW = 256;
+
+// Price levels per side carried in every snapshot (what the dashboard shows)
+constexpr int SNAPSHOT_LEVELS = 5;
+
+// Depths (in price levels) reported by the multi-depth imbalance
+constexpr int IMBALANCE_DEPTHS[] = {1, 3, 5};
+constexpr int NUM_IMBALANCE_DEPTHS = 3;
+constexpr int MAX_IMBALANCE_DEPTH = SNAPSHOT_LEVELS;
+
+// Fixed-capacity ring buffer; push() overwrites (and returns) the oldest entry when full
+template <typename T, size_t N>
+class RingBuffer {
+    static_assert((N & (N - 1)) == 0, "Capacity must be a power of two");
+    array<T, N> items{};
+    size_t head = 0;  // Next write position
+    size_t count = 0;
+
+public:
+    bool full() const { return count == N; }
+    size_t size() const { return count; }
+
+    // Returns true and fills 'evicted' if the window was full
+    bool push(const T& item, T& evicted) {
+        bool wasFull = full();
+        if (wasFull) evicted = items[head];
+        items[head] = item;
+        head = (head + 1) & (N - 1);
+        if (!wasFull) count++;
+        return wasFull;
+    }
+
+    // i = 0 is the oldest entry
+    const T& operator[](size_t i) const { return items[(head - count + i) & (N - 1)]; }
+    T& operator[](size_t i) { return items[(head - count + i) & (N - 1)]; }
+};
+
+// Neumaier-compensated running sum: the rounding error of every add (or
+// subtract) is carried in 'comp', so a window sum updated forever by
+// add/evict does not drift and never needs an O(window) rebuild
+struct CompensatedSum {
+    double sum = 0.0;
+    double comp = 0.0;
+
+    void add(double x) {
+        double t = sum + x;
+        if (fabs(sum) >= fabs(x)) comp += (sum - t) + x;
+        else comp += (x - t) + sum;
+        sum = t;
+    }
+
+    double value() const { return sum + comp; }
+};
+
+struct LevelView {
+    double price;
+    long long quantity;
+};
+
+// Everything a signal consumer (or the dashboard) needs, published as one consistent value
+struct AnalyticsSnapshot {
+    uint64_t updates = 0;       // Book events folded in so far
+    int bidLevels = 0;          // Valid entries in bids[] / asks[] (best first)
+    int askLevels = 0;
+    LevelView bids[SNAPSHOT_LEVELS] = {};
+    LevelView asks[SNAPSHOT_LEVELS] = {};
+    double bestBid = 0.0;
+    double bestAsk = 0.0;
+    long long bestBidQty = 0;
+    long long bestAskQty = 0;
+    double microprice = 0.0;    // Size-weighted mid: (bid * askQty + ask * bidQty) / (bidQty + askQty)
+    double imbalance[NUM_IMBALANCE_DEPTHS] = {}; // (bids - asks) / (bids + asks) over IMBALANCE_DEPTHS levels
+    double vwap = 0.0;          // Over the trade window
+    double tradeFlowImbalance = 0.0; // (buy - sell aggressor volume) / total, over the trade window
+    double realizedVol = 0.0;   // sqrt(sum of squared log returns) over the trade window
+    long long totalTrades = 0;
+    double lastTradePrice = 0.0;
+    long long lastTradeQty = 0;
+    Side lastTradeSide = Side::BUY;
+};
+
+// Incrementally maintained book signals. The book calls onTrade() per fill,
+// onRest() when an order joins a level and onBookUpdate() once per event, all
+// under its own lock (so there is a single writer); readers call snapshot() from
+// any thread without touching the book. Fills only update the window counters;
+// the snapshot is rebuilt and published only when the trade window or the top
+// levels changed. While no reader is subscribed, fills are just recorded and
+// nothing is published; the window sums are rebuilt once when a reader subscribes.
+// Every update is O(1).
+class BookAnalytics {
+private:
+    struct TradeSample { double price; long long qty; Side side; double logReturn; };
+
+    RingBuffer<TradeSample, ANALYTICS_WINDOW> trades;
+    CompensatedSum sumPV;        // Window sums, updated on push/evict
+    long long sumV = 0;
+    long long buyV = 0;
+    long long sellV = 0;
+    CompensatedSum sumR2;
+    double priceBeforeWindow = 0.0; // Last evicted trade (base of the oldest return)
+    bool dirty = false;          // Something the snapshot shows changed since the last publish
+    int readers = 0;             // Subscribed snapshot readers (changed under the book's lock)
+
+    AnalyticsSnapshot current;
+    SeqLock<AnalyticsSnapshot> published;
+
+    static double logReturn(double price, double previous) {
+        return (previous > 0 && price > 0 && price != previous) ? log(price / previous) : 0.0;
+    }
+
+    // O(window): recomputes the returns and window sums skipped while nobody was subscribed
+    void rebuildWindow() {
+        sumPV = {};
+        sumR2 = {};
+        sumV = buyV = sellV = 0;
+        double previous = priceBeforeWindow;
+        for (size_t i = 0; i < trades.size(); ++i) {
+            TradeSample& t = trades[i];
+            t.logReturn = logReturn(t.price, previous);
+            previous = t.price;
+            sumPV.add(t.price * t.qty);
+            sumV += t.qty;
+            (t.side == Side::BUY ? buyV : sellV) += t.qty;
+            sumR2.add(t.logReturn * t.logReturn);
+        }
+    }
+
+public:
+    void onTrade(double price, long long qty, Side aggressor) {
+        double previous = current.lastTradePrice;
+        current.totalTrades++;
+        current.lastTradePrice = price;
+        current.lastTradeQty = qty;
+        current.lastTradeSide = aggressor;
+
+        TradeSample evicted{};
+        if (readers == 0) {
+            // Nobody reads the signals: only record the trade (see rebuildWindow)
+            if (trades.push({price, qty, aggressor, 0.0}, evicted)) priceBeforeWindow = evicted.price;
+            return;
+        }
+
+        double r = logReturn(price, previous);
+        if (trades.push({price, qty, aggressor, r}, evicted)) {
+            priceBeforeWindow = evicted.price;
+            sumPV.add(-(evicted.price * evicted.qty));
+            sumV -= evicted.qty;
+            (evicted.side == Side::BUY ? buyV : sellV) -= evicted.qty;
+            sumR2.add(-(evicted.logReturn * evicted.logReturn));
+        }
+        sumPV.add(price * qty);
+        sumV += qty;
+        (aggressor == Side::BUY ? buyV : sellV) += qty;
+        sumR2.add(r * r);
+        dirty = true;
+    }
+
+    // An order rested at 'price'; only levels inside the snapshot depth matter
+    void onRest(Side side, double price) {
+        if (side == Side::BUY) {
+            if (current.bidLevels < SNAPSHOT_LEVELS || price >= current.bids[SNAPSHOT_LEVELS - 1].price) dirty = true;
+        } else {
+            if (current.askLevels < SNAPSHOT_LEVELS || price <= current.asks[SNAPSHOT_LEVELS - 1].price) dirty = true;
+        }
+    }
+
+    // Called once per book event with the top levels (best first) of each side
+    // Levels expose .first (price) and .second.quantity (aggregate size)
+    template <typename BidLevels, typename AskLevels>
+    void onBookUpdate(const BidLevels& bids, const AskLevels& asks) {
+        if (readers == 0 || !dirty) return;
+        dirty = false;
+
+        long long bidDepth[MAX_IMBALANCE_DEPTH] = {}, askDepth[MAX_IMBALANCE_DEPTH] = {};
+        int n = 0;
+        long long running = 0;
+        for (auto it = bids.begin(); it != bids.end() && n < MAX_IMBALANCE_DEPTH; ++it, ++n) {
+            current.bids[n] = {it->first, it->second.quantity};
+            running += it->second.quantity;
+            bidDepth[n] = running;
+        }
+        current.bidLevels = n;
+        for (; n < MAX_IMBALANCE_DEPTH; ++n) bidDepth[n] = running;
+        n = 0;
+        running = 0;
+        for (auto it = asks.begin(); it != asks.end() && n < MAX_IMBALANCE_DEPTH; ++it, ++n) {
+            current.asks[n] = {it->first, it->second.quantity};
+            running += it->second.quantity;
+            askDepth[n] = running;
+        }
+        current.askLevels = n;
+        for (; n < MAX_IMBALANCE_DEPTH; ++n) askDepth[n] = running;
+
+        current.bestBid = bids.empty() ? 0.0 : bids.begin()->first;
+        current.bestAsk = asks.empty() ? 0.0 : asks.begin()->first;
+        current.bestBidQty = bidDepth[0];
+        current.bestAskQty = askDepth[0];
+        long long top = current.bestBidQty + current.bestAskQty;
+        current.microprice = (bids.empty() || asks.empty() || top == 0) ? 0.0
+            : (current.bestBid * current.bestAskQty + current.bestAsk * current.bestBidQty) / top;
+
+        for (int d = 0; d < NUM_IMBALANCE_DEPTHS; ++d) {
+            long long b = bidDepth[IMBALANCE_DEPTHS[d] - 1], a = askDepth[IMBALANCE_DEPTHS[d] - 1];
+            current.imbalance[d] = (a + b == 0) ? 0.0 : (double)(b - a) / (a + b);
+        }
+
+        // Trade-window signals are derived once per event, not once per fill
+        current.vwap = sumV ? sumPV.value() / sumV : 0.0;
+        current.tradeFlowImbalance = sumV ? (double)(buyV - sellV) / sumV : 0.0;
+        current.realizedVol = sqrt(max(sumR2.value(), 0.0));
+
+        current.updates++;
+        published.store(current);
+    }
+
+    // A new reader gets a snapshot of the current book right away
+    template <typename BidLevels, typename AskLevels>
+    void addReader(const BidLevels& bids, const AskLevels& asks) {
+        if (readers++ == 0) rebuildWindow();
+        dirty = true;
+        onBookUpdate(bids, asks);
+    }
+
+    void removeReader() {
+        if (readers > 0) readers--;
+    }
+
+    // Lock-free, consistent copy of the latest published signals
+    AnalyticsSnapshot snapshot() const { return published.load(); }
+};
+
+#endif
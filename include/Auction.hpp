@@ -0,0 +1,163 @@
+#ifndef AUCTION_HPP
+#define AUCTION_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdlib>
+#include <algorithm>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// Result of a call-auction price discovery
+struct AuctionResult {
+    double price = 0.0;      // Clearing price (0 if nothing crosses)
+    long long volume = 0;    // Shares executed at the clearing price
+    long long imbalance = 0; // Demand minus supply at the clearing price (>0: buyers left over)
+};
+
+// Cumulative depth curves over a dense tick ladder.
+// Index i corresponds to price lo + i * tick.
+//   demand[i] = market buys + all bids priced >= price(i)
+//   supply[i] = market sells + all asks priced <= price(i)
+// The clearing level maximizes min(demand, supply); ties go to the smallest
+// surplus |demand - supply|, then to the lowest price.
+class AuctionLadder {
+private:
+    vector<long long> bidQty;
+    vector<long long> askQty;
+    vector<long long> cumBid;   // Inclusive prefix sum of bidQty
+    vector<long long> supply;   // Inclusive prefix sum of askQty (+ market sells)
+
+public:
+    struct Level { size_t index; long long volume; long long imbalance; };
+
+    // Resets the ladder to n empty levels (buffers are reused between auctions)
+    void reset(size_t n) {
+        bidQty.assign(n, 0);
+        askQty.assign(n, 0);
+        cumBid.resize(n);
+        supply.resize(n);
+    }
+
+    size_t size() const { return bidQty.size(); }
+    void addBid(size_t i, long long qty) { bidQty[i] += qty; }
+    void addAsk(size_t i, long long qty) { askQty[i] += qty; }
+
+    Level findClearingLevel(long long marketBuyQty, long long marketSellQty) {
+        const size_t n = bidQty.size();
+        if (n == 0) return {0, 0, 0};
+
+        // Pass 1: prefix sums for both sides
+        long long totalBid = prefixSum(bidQty.data(), cumBid.data(), n, 0);
+        prefixSum(askQty.data(), supply.data(), n, marketSellQty);
+
+        // Pass 2: executable volume per level + best-level reduction
+        return selectLevel(totalBid + marketBuyQty, n);
+    }
+
+private:
+    static bool better(long long vol, long long sur, long long bestVol, long long bestSur) {
+        return vol > bestVol || (vol == bestVol && sur < bestSur);
+    }
+
+#if defined(__AVX2__)
+    // In-register inclusive scan of 4 x int64: [a,b,c,d] -> [a,a+b,a+b+c,a+b+c+d]
+    static __m256i scan4(__m256i x) {
+        x = _mm256_add_epi64(x, _mm256_slli_si256(x, 8));                 // [a,a+b,c,c+d]
+        __m256i carry = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(1, 1, 0, 0)); // [-,-,a+b,a+b]
+        carry = _mm256_blend_epi32(_mm256_setzero_si256(), carry, 0xF0);
+        return _mm256_add_epi64(x, carry);
+    }
+#endif
+
+    // out[i] = base + in[0] + ... + in[i]; returns the sum of in[]
+    static long long prefixSum(const long long* in, long long* out, size_t n, long long base) {
+        size_t i = 0;
+        long long running = base;
+#if defined(__AVX2__)
+        __m256i offset = _mm256_set1_epi64x(base);
+        for (; i + 4 <= n; i += 4) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            x = _mm256_add_epi64(scan4(x), offset);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), x);
+            offset = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 3, 3, 3));
+        }
+        if (i > 0) running = out[i - 1];
+#endif
+        for (; i < n; ++i) {
+            running += in[i];
+            out[i] = running;
+        }
+        return running - base;
+    }
+
+    Level selectLevel(long long totalDemand, size_t n) {
+        Level best{0, 0, 0};
+        size_t i = 0;
+#if defined(__AVX2__)
+        if (n >= 4) {
+            const __m256i total = _mm256_set1_epi64x(totalDemand);
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i step = _mm256_set1_epi64x(4);
+            __m256i idx = _mm256_setr_epi64x(0, 1, 2, 3);
+            __m256i bestVol = _mm256_set1_epi64x(-1);
+            __m256i bestSur = zero;
+            __m256i bestIdx = zero;
+
+            for (; i + 4 <= n; i += 4) {
+                __m256i cb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cumBid.data() + i));
+                __m256i bq = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bidQty.data() + i));
+                __m256i s  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(supply.data() + i));
+                // demand(i) = total - (bids below i) = total - cumBid + bidQty
+                __m256i d = _mm256_add_epi64(_mm256_sub_epi64(total, cb), bq);
+
+                __m256i dGreater = _mm256_cmpgt_epi64(d, s);
+                __m256i vol = _mm256_blendv_epi8(d, s, dGreater);
+                __m256i diff = _mm256_sub_epi64(d, s);
+                __m256i sur = _mm256_blendv_epi8(_mm256_sub_epi64(zero, diff), diff, dGreater);
+
+                __m256i take = _mm256_or_si256(
+                    _mm256_cmpgt_epi64(vol, bestVol),
+                    _mm256_and_si256(_mm256_cmpeq_epi64(vol, bestVol),
+                                     _mm256_cmpgt_epi64(bestSur, sur)));
+                bestVol = _mm256_blendv_epi8(bestVol, vol, take);
+                bestSur = _mm256_blendv_epi8(bestSur, sur, take);
+                bestIdx = _mm256_blendv_epi8(bestIdx, idx, take);
+                idx = _mm256_add_epi64(idx, step);
+            }
+
+            // Horizontal reduction (equal keys resolve to the lower index)
+            alignas(32) long long v[4], su[4], ix[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(v), bestVol);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(su), bestSur);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(ix), bestIdx);
+            best = {(size_t)ix[0], v[0], su[0]};
+            for (int lane = 1; lane < 4; ++lane) {
+                if (better(v[lane], su[lane], best.volume, best.imbalance) ||
+                    (v[lane] == best.volume && su[lane] == best.imbalance && (size_t)ix[lane] < best.index)) {
+                    best = {(size_t)ix[lane], v[lane], su[lane]};
+                }
+            }
+        }
+#endif
+        bool haveBest = (i > 0);
+        for (; i < n; ++i) {
+            long long d = totalDemand - cumBid[i] + bidQty[i];
+            long long s = supply[i];
+            long long vol = min(d, s);
+            long long sur = llabs(d - s);
+            if (!haveBest || better(vol, sur, best.volume, best.imbalance)) {
+                best = {i, vol, sur};
+                haveBest = true;
+            }
+        }
+        // The reduction ranks by |imbalance|; report it signed
+        best.imbalance = totalDemand - cumBid[best.index] + bidQty[best.index] - supply[best.index];
+        return best;
+    }
+};
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef DASHBOARD_HPP
+#define DASHBOARD_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <cerrno>
+#include <unistd.h>
+#include "Analytics.hpp"
+
+using namespace std;
+
+// Engine counters shown in the header line (owned by the simulator, not the book)
+struct HudStats {
+    int ordersProcessed;
+    double avgLatencyUs;
+    int pendingStops;
+};
+
+// Allocation-free dashboard renderer.
+// Each frame is formatted from one AnalyticsSnapshot into a fixed buffer and
+// written with a single write() call; the book is never locked.
+class DashboardRenderer {
+private:
+    static constexpr size_t CAPACITY = 4096;
+    static constexpr int MAX_BAR = 40; // Longest depth bar ('*' per 5 shares)
+
+    char buffer[CAPACITY];
+    size_t length = 0;
+
+    // --- APPENDERS (silently truncate at CAPACITY) ---
+    void append(const char* text, size_t n) {
+        if (n > CAPACITY - length) n = CAPACITY - length;
+        memcpy(buffer + length, text, n);
+        length += n;
+    }
+
+    template <size_t N>
+    void append(const char (&literal)[N]) { append(literal, N - 1); }
+
+    void appendRepeat(char c, int count) {
+        if (count <= 0) return;
+        size_t n = min((size_t)count, CAPACITY - length);
+        memset(buffer + length, c, n);
+        length += n;
+    }
+
+    void appendInt(long long value, int width = 0) {
+        char digits[24];
+        int n = 0;
+        bool negative = value < 0;
+        unsigned long long v = negative ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+        do {
+            digits[n++] = (char)('0' + v % 10);
+            v /= 10;
+        } while (v);
+        if (negative) digits[n++] = '-';
+        appendRepeat(' ', width - n);
+        char text[24];
+        for (int i = 0; i < n; ++i) text[i] = digits[n - 1 - i];
+        append(text, n);
+    }
+
+    void appendFixed(double value, int decimals, int width = 0, bool showSign = false) {
+        static const long long SCALE[] = {1, 10, 100, 1000, 10000};
+        long long scaled = llround(fabs(value) * SCALE[decimals]);
+        long long whole = scaled / SCALE[decimals];
+        long long frac = scaled % SCALE[decimals];
+
+        char text[32];
+        int n = 0;
+        if (value < 0 && scaled != 0) text[n++] = '-';
+        else if (showSign) text[n++] = '+';
+        char digits[24];
+        int d = 0;
+        do {
+            digits[d++] = (char)('0' + whole % 10);
+            whole /= 10;
+        } while (whole);
+        while (d) text[n++] = digits[--d];
+        if (decimals > 0) {
+            text[n++] = '.';
+            for (int i = decimals - 1; i >= 0; --i) {
+                text[n + i] = (char)('0' + frac % 10);
+                frac /= 10;
+            }
+            n += decimals;
+        }
+        appendRepeat(' ', width - n);
+        append(text, n);
+    }
+
+    // [          |#####     ] for +0.5, mirrored for negative values
+    void appendImbalanceBar(double imbalance) {
+        const int width = 10;
+        int fill = (int)(fabs(imbalance) * width);
+        if (fill > width) fill = width;
+        append("[");
+        if (imbalance > 0) {
+            appendRepeat(' ', width);
+            append("|");
+            appendRepeat('#', fill);
+            appendRepeat(' ', width - fill);
+        } else {
+            appendRepeat(' ', width - fill);
+            appendRepeat('#', fill);
+            append("|");
+            appendRepeat(' ', width);
+        }
+        append("]");
+    }
+
+    void appendLevel(const LevelView& level) {
+        append("   $");
+        appendFixed(level.price, 2, 7);
+        append(" | ");
+        appendRepeat('*', (int)min<long long>(level.quantity / 5, MAX_BAR));
+        append(" (");
+        appendInt(level.quantity);
+        append(")\033[K\n");
+    }
+
+public:
+    // Formats one frame; returns its size in bytes
+    size_t render(const AnalyticsSnapshot& snap, const HudStats& hud) {
+        length = 0;
+        double imbalance = snap.imbalance[NUM_IMBALANCE_DEPTHS - 1];
+
+        // Cursor home: redraw in place instead of scrolling (each line clears its tail)
+        append("\033[H");
+        append("================================================\033[K\n");
+        append(" [SYSTEM STATUS]  Orders: ");
+        appendInt(hud.ordersProcessed, 5);
+        append(" | Latency: ");
+        appendInt((long long)hud.avgLatencyUs, 3);
+        append(" us | Stops: ");
+        appendInt(hud.pendingStops, 3);
+        append("\033[K\n================================================\033[K\n");
+
+        // MARKET SENTIMENT
+        append(" Signal    : ");
+        if (imbalance > 0.3) append("\033[32m");
+        else if (imbalance < -0.3) append("\033[31m");
+        appendImbalanceBar(imbalance);
+        if (imbalance > 0.3) append(" BULLISH");
+        else if (imbalance < -0.3) append(" BEARISH");
+        else append(" NEUTRAL");
+        append("\033[0m\033[K\n");
+
+        append(" Micro: $");
+        appendFixed(snap.microprice, 2);
+        append(" | VWAP: $");
+        appendFixed(snap.vwap, 2);
+        append(" | Flow: ");
+        appendFixed(snap.tradeFlowImbalance, 2, 0, true);
+        append(" | Vol: ");
+        appendFixed(snap.realizedVol, 4);
+        append("\033[K\n------------------------------------------------\033[K\n");
+
+        // ORDER BOOK VISUALIZATION
+        append("   ASKS (Sellers)\033[K\n");
+        for (int i = snap.askLevels - 1; i >= 0; --i) appendLevel(snap.asks[i]);
+        append("   ---------------------------------\033[K\n");
+        for (int i = 0; i < snap.bidLevels; ++i) appendLevel(snap.bids[i]);
+        append("   BIDS (Buyers)\033[K\n------------------------------------------------\033[K\n");
+
+        // LAST TRADE
+        if (snap.totalTrades > 0) {
+            append(" LAST TRADE: ");
+            if (snap.lastTradeSide == Side::BUY) append("\033[32mBUY \033[0m");
+            else append("\033[31mSELL\033[0m");
+            appendInt(snap.lastTradeQty);
+            append(" @ $");
+            appendFixed(snap.lastTradePrice, 2);
+            append("\033[K\n");
+        } else {
+            append(" LAST TRADE: (Waiting...)\033[K\n");
+        }
+
+        append("================================================\033[K\n");
+        append(" [ENTER] to Stop and View Full Trade Log\033[K\n\033[J");
+        return length;
+    }
+
+    // One write() per frame (retried only on partial writes / EINTR)
+    bool flush(int fd) const {
+        size_t written = 0;
+        while (written < length) {
+            ssize_t n = write(fd, buffer + written, length - written);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            written += (size_t)n;
+        }
+        return true;
+    }
+
+    const char* data() const { return buffer; }
+    size_t size() const { return length; }
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <string>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Read-only memory-mapped file (RAII). The kernel pages the file in on demand,
+// so large order-flow files are streamed without copying into user buffers.
+class MappedFile {
+private:
+    const char* bytes = nullptr;
+    size_t length = 0;
+
+public:
+    explicit MappedFile(const string& path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw runtime_error("Cannot open " + path);
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            throw runtime_error("Cannot stat " + path);
+        }
+        length = (size_t)st.st_size;
+
+        if (length > 0) {
+            void* addr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                close(fd);
+                throw runtime_error("Cannot mmap " + path);
+            }
+            madvise(addr, length, MADV_SEQUENTIAL); // Aggressive read-ahead
+            bytes = static_cast<const char*>(addr);
+        }
+        close(fd); // Mapping stays valid after close
+    }
+
+    ~MappedFile() {
+        if (bytes) munmap(const_cast<char*>(bytes), length);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+    const char* begin() const { return bytes; }
+    const char* end() const { return bytes + length; }
+};
+
+#endif
@@ -7,21 +7,57 @@
 #include <mutex>
 #include <atomic>
 #include <algorithm>
-#include "Order.hpp"
+#include <cmath>
+#include <stdexcept>
+#include "order.hpp"
+#include "Auction.hpp"
+#include "Analytics.hpp"
 
 using namespace std;
 
+// Largest dense tick ladder an auction will allocate; sparser books fall back
+// to evaluating only their distinct limit prices
+constexpr size_t MAX_AUCTION_LADDER = 1 << 20;
+
 // Struct for Trade History
 struct TradeInfo {
     double price;
-    int quantity;
+    long long quantity; // An auction print carries the whole uncross volume
     Side side; // Who initiated? (Aggressor)
 };
 
+// One price level: FIFO queue plus its aggregate size (kept in sync on every fill)
+struct PriceLevel {
+    vector<Order> orders;
+    long long quantity = 0;
+
+    void push(Order&& order) {
+        quantity += order.quantity;
+        orders.push_back(std::move(order));
+    }
+};
+
+// Cumulative fill statistics (for batch replays)
+struct BookStats {
+    long long trades = 0;
+    long long sharesTraded = 0;
+    double notional = 0.0;   // Sum of price * quantity
+    size_t bidLevels = 0;    // Resting price levels per side (filled in by getStats())
+    size_t askLevels = 0;
+
+    double vwap() const { return sharesTraded ? notional / sharesTraded : 0.0; }
+};
+
+// CONTINUOUS: match on arrival. AUCTION: accumulate, then uncross() in one pass.
+enum class MatchingMode {
+    CONTINUOUS,
+    AUCTION
+};
+
 class OrderBook {
 private:
-    map<double, vector<Order>> asks;
-    map<double, vector<Order>, greater<double>> bids;
+    map<double, PriceLevel> asks;
+    map<double, PriceLevel, greater<double>> bids;
     
     // Stop Orders (waiting to be triggered) - indexed by stop price
     multimap<double, Order> buyStopOrders;  // BUY stops (trigger when price rises)
@@ -30,6 +66,8 @@ private:
     
     // History Buffer
     deque<TradeInfo> lastTrades; // Stores last 5 trades
+    BookStats stats;
+    BookAnalytics analytics; // Incremental signals, published lock-free
     
     // Prevent recursive stop checking
     bool isCheckingStops = false;
@@ -37,10 +75,17 @@ private:
     // Lazy cleanup counters (Profile #2: reduce check frequency)
     int tradesSinceLastStopCheck = 0;
     
+    // Call Auction State
+    MatchingMode mode = MatchingMode::CONTINUOUS;
+    vector<Order> auctionMarketBuys;  // Market orders wait for the uncross
+    vector<Order> auctionMarketSells;
+    AuctionLadder auctionLadder;      // Reused depth-curve buffers
+    vector<double> auctionPrices;     // Distinct limit prices (sparse ladder fallback)
+
     mutable std::mutex bookMtx;
 
     // --- CORE MATCHING LOGIC ---
-    void executeTrade(Order& incoming, Order& bookOrder) {
+    void executeTrade(Order& incoming, Order& bookOrder, PriceLevel& level) {
         int tradeQty = min(incoming.quantity, bookOrder.quantity);
         
         // 1. Store Trade in History (Keep max 5)
@@ -50,9 +95,15 @@ private:
             lastTrades.pop_back();
         }
 
+        stats.trades++;
+        stats.sharesTraded += tradeQty;
+        stats.notional += bookOrder.price * tradeQty;
+        analytics.onTrade(bookOrder.price, tradeQty, incoming.side);
+
         // 2. Update Quantities
         incoming.quantity -= tradeQty;
         bookOrder.quantity -= tradeQty;
+        level.quantity -= tradeQty;
     }
 
     // Check and trigger stop orders based on market price (optimized)
@@ -96,12 +147,12 @@ private:
         if (order.side == Side::BUY) {
             while (order.quantity > 0 && !asks.empty()) {
                 auto bestAskIt = asks.begin();
-                vector<Order>& bookOrders = bestAskIt->second;
+                vector<Order>& bookOrders = bestAskIt->second.orders;
                 for (auto it = bookOrders.begin(); it != bookOrders.end(); ) {
-                    executeTrade(order, *it);
+                    executeTrade(order, *it, bestAskIt->second);
                     if (it->quantity == 0) it = bookOrders.erase(it);
                     else ++it;
-                    if (order.quantity == 0) return;
+                    if (order.quantity == 0) break; // Still erase the level if this emptied it
                 }
                 if (bookOrders.empty()) asks.erase(bestAskIt);
             }
@@ -109,19 +160,151 @@ private:
         else { 
             while (order.quantity > 0 && !bids.empty()) {
                 auto bestBidIt = bids.begin();
-                vector<Order>& bookOrders = bestBidIt->second;
+                vector<Order>& bookOrders = bestBidIt->second.orders;
                 for (auto it = bookOrders.begin(); it != bookOrders.end(); ) {
-                    executeTrade(order, *it);
+                    executeTrade(order, *it, bestBidIt->second);
                     if (it->quantity == 0) it = bookOrders.erase(it);
                     else ++it;
-                    if (order.quantity == 0) return;
+                    if (order.quantity == 0) break; // Still erase the level if this emptied it
                 }
                 if (bookOrders.empty()) bids.erase(bestBidIt);
             }
         }
     }
 
+    // --- CALL AUCTION LOGIC ---
+    AuctionResult computeAuction(double tickSize) {
+        if (!(tickSize > 0)) throw invalid_argument("Auction tick size must be positive");
+        AuctionResult result;
+        if (bids.empty() && asks.empty()) return result; // No limit price to discover
+
+        // Ladder spans every resting limit price on both sides
+        double lo = !bids.empty() ? bids.rbegin()->first : asks.begin()->first;
+        double hi = !bids.empty() ? bids.begin()->first : asks.rbegin()->first;
+        if (!asks.empty()) {
+            lo = min(lo, asks.begin()->first);
+            hi = max(hi, asks.rbegin()->first);
+        }
+        double span = (hi - lo) / tickSize;
+        bool dense = span < (double)MAX_AUCTION_LADDER;
+
+        if (dense) {
+            auctionLadder.reset((size_t)llround(span) + 1);
+            for (auto& entry : bids) {
+                auctionLadder.addBid((size_t)llround((entry.first - lo) / tickSize), entry.second.quantity);
+            }
+            for (auto& entry : asks) {
+                auctionLadder.addAsk((size_t)llround((entry.first - lo) / tickSize), entry.second.quantity);
+            }
+        } else {
+            // Too sparse for a dense tick ladder (e.g. one stray outlier price):
+            // evaluate only the distinct limit prices instead
+            auctionPrices.clear();
+            for (auto it = bids.rbegin(); it != bids.rend(); ++it) auctionPrices.push_back(it->first);
+            size_t bidCount = auctionPrices.size();
+            for (auto& entry : asks) auctionPrices.push_back(entry.first);
+            inplace_merge(auctionPrices.begin(), auctionPrices.begin() + bidCount, auctionPrices.end());
+            auctionPrices.erase(unique(auctionPrices.begin(), auctionPrices.end()), auctionPrices.end());
+
+            auto rank = [&](double price) {
+                return (size_t)(lower_bound(auctionPrices.begin(), auctionPrices.end(), price) - auctionPrices.begin());
+            };
+            auctionLadder.reset(auctionPrices.size());
+            for (auto& entry : bids) auctionLadder.addBid(rank(entry.first), entry.second.quantity);
+            for (auto& entry : asks) auctionLadder.addAsk(rank(entry.first), entry.second.quantity);
+        }
+        long long marketBuyQty = 0, marketSellQty = 0;
+        for (auto& o : auctionMarketBuys) marketBuyQty += o.quantity;
+        for (auto& o : auctionMarketSells) marketSellQty += o.quantity;
+
+        AuctionLadder::Level level = auctionLadder.findClearingLevel(marketBuyQty, marketSellQty);
+        if (level.volume <= 0) return result;
+
+        result.price = dense ? lo + level.index * tickSize : auctionPrices[level.index];
+        result.volume = level.volume;
+        result.imbalance = level.imbalance;
+        return result;
+    }
+
+    // Fills qty shares from one side: market orders first, then price-time priority
+    template <typename Levels, typename Eligible>
+    void fillAuctionSide(vector<Order>& marketOrders, Levels& levels, Eligible eligible, long long qty) {
+        for (auto& o : marketOrders) {
+            if (qty == 0) return;
+            int fill = (int)min<long long>(qty, o.quantity);
+            o.quantity -= fill;
+            qty -= fill;
+        }
+        while (qty > 0 && !levels.empty() && eligible(levels.begin()->first)) {
+            auto levelIt = levels.begin();
+            vector<Order>& bookOrders = levelIt->second.orders;
+            for (auto it = bookOrders.begin(); it != bookOrders.end() && qty > 0; ) {
+                int fill = (int)min<long long>(qty, it->quantity);
+                it->quantity -= fill;
+                levelIt->second.quantity -= fill;
+                qty -= fill;
+                if (it->quantity == 0) it = bookOrders.erase(it);
+                else ++it;
+            }
+            if (bookOrders.empty()) levels.erase(levelIt);
+        }
+    }
+
+    // Caller holds bookMtx
+    AuctionResult uncrossLocked(double tickSize) {
+        AuctionResult result = computeAuction(tickSize);
+        if (result.volume > 0) {
+            double eps = tickSize / 2;
+            double px = result.price;
+            fillAuctionSide(auctionMarketBuys, bids, [&](double p) { return p >= px - eps; }, result.volume);
+            fillAuctionSide(auctionMarketSells, asks, [&](double p) { return p <= px + eps; }, result.volume);
+
+            // One print for the whole uncross, tagged with the side that had excess interest
+            lastTrades.push_front({px, result.volume, result.imbalance >= 0 ? Side::BUY : Side::SELL});
+            if (lastTrades.size() > 5) {
+                lastTrades.pop_back();
+            }
+            stats.trades++;
+            stats.sharesTraded += result.volume;
+            stats.notional += px * result.volume;
+            analytics.onTrade(px, result.volume, result.imbalance >= 0 ? Side::BUY : Side::SELL);
+        }
+        auctionMarketBuys.clear();
+        auctionMarketSells.clear();
+        analytics.onBookUpdate(bids, asks);
+        return result;
+    }
+
 public:
+    // Leaving AUCTION always uncrosses first (at tickSize), so continuous matching
+    // never starts from a crossed book or with stranded auction market orders
+    void setMatchingMode(MatchingMode newMode, double tickSize = 0.01) {
+        lock_guard<mutex> lock(bookMtx);
+        if (mode == MatchingMode::AUCTION && newMode == MatchingMode::CONTINUOUS) {
+            uncrossLocked(tickSize);
+        }
+        mode = newMode;
+    }
+
+    MatchingMode getMatchingMode() const {
+        lock_guard<mutex> lock(bookMtx);
+        return mode;
+    }
+
+    // Indicative clearing price/volume without executing anything
+    AuctionResult getIndicativeAuction(double tickSize = 0.01) {
+        lock_guard<mutex> lock(bookMtx);
+        return computeAuction(tickSize);
+    }
+
+    // Executes the whole auction at a single price. Unfilled market orders are
+    // cancelled; unfilled limit orders keep resting. Stops are not triggered by
+    // the auction print (they resume with continuous matching).
+    AuctionResult uncross(double tickSize = 0.01) {
+        lock_guard<mutex> lock(bookMtx);
+        return uncrossLocked(tickSize);
+    }
+
     void addOrder(Order order) { 
         lock_guard<mutex> lock(bookMtx);
 
@@ -136,18 +319,38 @@ public:
             return;
         }
 
-        if (order.type == OrderType::MARKET) {
-            matchMarketOrder(order);
-            return; 
+        // Auction: everything rests until uncross()
+        if (mode == MatchingMode::AUCTION) {
+            if (order.type == OrderType::MARKET) {
+                if (order.side == Side::BUY) auctionMarketBuys.push_back(std::move(order));
+                else auctionMarketSells.push_back(std::move(order));
+            } else if (order.side == Side::BUY) {
+                analytics.onRest(Side::BUY, order.price);
+                bids[order.price].push(std::move(order));
+            } else {
+                analytics.onRest(Side::SELL, order.price);
+                asks[order.price].push(std::move(order));
+            }
+            analytics.onBookUpdate(bids, asks);
+            return;
         }
 
-        if (order.side == Side::BUY) {
+        if (order.type == OrderType::MARKET) {
+            matchMarketOrder(order);
+        } else if (order.side == Side::BUY) {
             matchBuyOrder(order);
-            if (order.quantity > 0) bids[order.price].push_back(std::move(order));
+            if (order.quantity > 0) {
+                analytics.onRest(Side::BUY, order.price);
+                bids[order.price].push(std::move(order));
+            }
         } else {
             matchSellOrder(order);
-            if (order.quantity > 0) asks[order.price].push_back(std::move(order));
+            if (order.quantity > 0) {
+                analytics.onRest(Side::SELL, order.price);
+                asks[order.price].push(std::move(order));
+            }
         }
+        analytics.onBookUpdate(bids, asks); // Publishes only if this event changed what it shows
     }
 
     void matchBuyOrder(Order& order) {
@@ -158,9 +361,9 @@ public:
             if (order.price < bestPrice) break;
 
             hadMatch = true;
-            vector<Order>& bookOrders = bestAskIt->second;
+            vector<Order>& bookOrders = bestAskIt->second.orders;
             for (auto it = bookOrders.begin(); it != bookOrders.end(); ) {
-                executeTrade(order, *it);
+                executeTrade(order, *it, bestAskIt->second);
                 if (it->quantity == 0) it = bookOrders.erase(it);
                 else ++it;
                 if (order.quantity == 0) break;
@@ -186,9 +389,9 @@ public:
             if (order.price > bestPrice) break;
 
             hadMatch = true;
-            vector<Order>& bookOrders = bestBidIt->second;
+            vector<Order>& bookOrders = bestBidIt->second.orders;
             for (auto it = bookOrders.begin(); it != bookOrders.end(); ) {
-                executeTrade(order, *it);
+                executeTrade(order, *it, bestBidIt->second);
                 if (it->quantity == 0) it = bookOrders.erase(it);
                 else ++it;
                 if (order.quantity == 0) break;
@@ -213,16 +416,12 @@ public:
         lock_guard<mutex> lock(bookMtx);
         int count = 0;
         for (auto& entry : asks) {
-            int qty = 0;
-            for (auto& o : entry.second) qty += o.quantity;
-            bestAsks.push_back({entry.first, qty});
+            bestAsks.push_back({entry.first, (int)entry.second.quantity});
             if (++count >= 5) break;
         }
         count = 0;
         for (auto& entry : bids) {
-            int qty = 0;
-            for (auto& o : entry.second) qty += o.quantity;
-            bestBids.push_back({entry.first, qty});
+            bestBids.push_back({entry.first, (int)entry.second.quantity});
             if (++count >= 5) break;
         }
     }
@@ -233,26 +432,40 @@ public:
         return vector<TradeInfo>(lastTrades.begin(), lastTrades.end());
     }
 
+    BookStats getStats() const {
+        lock_guard<mutex> lock(bookMtx);
+        BookStats result = stats;
+        result.bidLevels = bids.size();
+        result.askLevels = asks.size();
+        return result;
+    }
+
     // Get count of pending stop orders (lock-free)
     int getPendingStopOrders() const {
         return pendingStopCount.load();
     }
 
-    double getImbalance() {
+    // Snapshots are only built while someone reads them: subscribe before calling
+    // getAnalytics()/getImbalance() and unsubscribe when done. Without a subscriber
+    // the matcher only updates the trade-window counters.
+    void subscribeAnalytics() {
         lock_guard<mutex> lock(bookMtx);
-        double totalBids = 0, totalAsks = 0;
-        int count = 0;
-        for (auto& entry : bids) {
-            for (auto& o : entry.second) totalBids += o.quantity;
-            if (++count >= 5) break;
-        }
-        count = 0;
-        for (auto& entry : asks) {
-            for (auto& o : entry.second) totalAsks += o.quantity;
-            if (++count >= 5) break;
-        }
-        double total = totalBids + totalAsks;
-        return (total == 0) ? 0.0 : (totalBids - totalAsks) / total;
+        analytics.addReader(bids, asks);
+    }
+
+    void unsubscribeAnalytics() {
+        lock_guard<mutex> lock(bookMtx);
+        analytics.removeReader();
+    }
+
+    // Lock-free: latest incrementally maintained signals (never touches the book)
+    AnalyticsSnapshot getAnalytics() const {
+        return analytics.snapshot();
+    }
+
+    // Top-5-level imbalance (lock-free, from the analytics snapshot)
+    double getImbalance() const {
+        return analytics.snapshot().imbalance[NUM_IMBALANCE_DEPTHS - 1];
     }
 };
 
@@ -5,49 +5,101 @@
 #include "order.hpp"
 using namespace std;
 
+// Result of a non-blocking poll()
+enum class PollResult {
+    ORDER,  // Got one
+    EMPTY,  // Nothing yet, try again
+    DONE    // stop() was called and everything has been drained
+};
+
 class OrderQueue {
+public:
+    using TimePoint = chrono::steady_clock::time_point;
+
 private:
-    queue<Order> queue;
+    // Enqueue time travels with the order so the consumer can measure wakeup latency
+    struct Entry {
+        Order order;
+        TimePoint enqueuedAt;
+    };
+
+    // Entry count in the low bits, FINISHED once stop() was called.
+    // Written under the mutex, read lock-free by poll() so an idle spin never locks.
+    static constexpr uint64_t FINISHED = 1ULL << 63;
+
+    queue<Entry> entries;
     mutex mtx;
     condition_variable cv;
-    bool finished = false;
+    atomic<uint64_t> state{0};
+    int sleepers = 0; // Consumers blocked in pop() (guarded by mtx)
 
 public:
     // PRODUCER calls this
     void push(Order order) {
+        bool wake;
         {
             // Lock the door
             lock_guard<mutex> lock(mtx);
-            queue.push(std::move(order));
+            entries.push({std::move(order), chrono::steady_clock::now()});
+            state.fetch_add(1, memory_order_release);
+            wake = sleepers > 0;
         } // Lock releases automatically
         
-        // Wake up the consumer!
-        cv.notify_one();
+        // Wake up the consumer (only if one is actually asleep)
+        if (wake) cv.notify_one();
     }
 
     // CONSUMER calls this
     // Returns true if we got an order, false if we should shut down
     bool pop(Order& order) {
+        TimePoint enqueuedAt;
+        return pop(order, enqueuedAt);
+    }
+
+    bool pop(Order& order, TimePoint& enqueuedAt) {
         unique_lock<mutex> lock(mtx);
         
         // Wait until queue is NOT empty OR we are finished
         // This prevents "busy waiting" (burning CPU)
-        cv.wait(lock, [this] { return !queue.empty() || finished; });
+        sleepers++;
+        cv.wait(lock, [this] { return state.load(memory_order_relaxed) != 0; });
+        sleepers--;
 
-        if (queue.empty() && finished) {
+        if (entries.empty()) {
             return false; // Time to stop
         }
 
-        order = queue.front();
-        queue.pop();
+        order = std::move(entries.front().order);
+        enqueuedAt = entries.front().enqueuedAt;
+        entries.pop();
+        state.fetch_sub(1, memory_order_relaxed);
         return true;
     }
 
+    // BUSY-POLL CONSUMER calls this instead (never sleeps)
+    // Empty and done checks are a single atomic load; the lock is only taken
+    // once an entry is visible
+    PollResult poll(Order& order, TimePoint& enqueuedAt) {
+        uint64_t s = state.load(memory_order_acquire);
+        if ((s & ~FINISHED) == 0) return (s & FINISHED) ? PollResult::DONE : PollResult::EMPTY;
+
+        lock_guard<mutex> lock(mtx);
+        if (entries.empty()) {
+            // Another consumer took it between the load and the lock
+            return (state.load(memory_order_relaxed) & FINISHED) ? PollResult::DONE : PollResult::EMPTY;
+        }
+        order = std::move(entries.front().order);
+        enqueuedAt = entries.front().enqueuedAt;
+        entries.pop();
+        state.fetch_sub(1, memory_order_relaxed);
+        return PollResult::ORDER;
+    }
+
     // Signal that no more orders are coming
     void stop() {
         {
             lock_guard<mutex> lock(mtx);
-            finished = true;
+            state.fetch_or(FINISHED, memory_order_release);
         }
         cv.notify_all(); // Wake everyone up so they can exit
     }
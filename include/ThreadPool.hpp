@@ -0,0 +1,139 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+
+using namespace std;
+
+// Work-stealing thread pool.
+// Each worker owns a deque: it pops its own work from the back and steals from
+// the front of other workers' deques when it runs dry. Tasks a worker submits
+// itself go on the back (LIFO, cache-warm); external submissions go on the
+// front, so every worker runs them in submission order and thieves take the
+// most recently submitted ones.
+class ThreadPool {
+private:
+    struct WorkerQueue {
+        deque<function<void()>> tasks;
+        mutex mtx;
+    };
+
+    vector<unique_ptr<WorkerQueue>> queues;
+    vector<thread> workers;
+
+    mutex sleepMtx;
+    condition_variable workAvailable;
+    condition_variable allDone;
+    atomic<int> queuedTasks{0};   // Submitted but not yet started
+    atomic<int> pendingTasks{0};  // Submitted but not yet finished
+    atomic<unsigned> nextQueue{0};
+    bool stopping = false;
+
+    // Identifies the calling worker (nullptr / -1 outside any pool)
+    static thread_local ThreadPool* currentPool;
+    static thread_local int workerIndex;
+
+    bool tryPop(int self, function<void()>& task) {
+        // 1. Own queue (back)
+        {
+            WorkerQueue& own = *queues[self];
+            lock_guard<mutex> lock(own.mtx);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        // 2. Steal from the others (front)
+        int n = (int)queues.size();
+        for (int k = 1; k < n; ++k) {
+            WorkerQueue& victim = *queues[(self + k) % n];
+            lock_guard<mutex> lock(victim.mtx);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(int self) {
+        currentPool = this;
+        workerIndex = self;
+        function<void()> task;
+        while (true) {
+            if (tryPop(self, task)) {
+                queuedTasks--;
+                task();
+                task = nullptr;
+                if (--pendingTasks == 0) {
+                    lock_guard<mutex> lock(sleepMtx);
+                    allDone.notify_all();
+                }
+                continue;
+            }
+            unique_lock<mutex> lock(sleepMtx);
+            workAvailable.wait(lock, [this] { return stopping || queuedTasks.load() > 0; });
+            if (stopping && queuedTasks.load() == 0) return;
+        }
+    }
+
+public:
+    explicit ThreadPool(unsigned numThreads = thread::hardware_concurrency()) {
+        if (numThreads == 0) numThreads = 1;
+        for (unsigned i = 0; i < numThreads; ++i) queues.push_back(make_unique<WorkerQueue>());
+        for (unsigned i = 0; i < numThreads; ++i) workers.emplace_back(&ThreadPool::workerLoop, this, (int)i);
+    }
+
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lock(sleepMtx);
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        for (auto& t : workers) t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    // Tasks submitted from a worker stay on that worker's deque;
+    // external submissions are spread round-robin.
+    void submit(function<void()> task) {
+        bool fromWorker = (currentPool == this);
+        int target = fromWorker ? workerIndex : (int)(nextQueue++ % queues.size());
+        pendingTasks++;
+        {
+            WorkerQueue& q = *queues[target];
+            lock_guard<mutex> lock(q.mtx);
+            if (fromWorker) q.tasks.push_back(std::move(task));
+            else q.tasks.push_front(std::move(task));
+        }
+        {
+            lock_guard<mutex> lock(sleepMtx);
+            queuedTasks++;
+        }
+        workAvailable.notify_one();
+    }
+
+    // Blocks until every submitted task has finished
+    void wait() {
+        unique_lock<mutex> lock(sleepMtx);
+        allDone.wait(lock, [this] { return pendingTasks.load() == 0; });
+    }
+};
+
+inline thread_local ThreadPool* ThreadPool::currentPool = nullptr;
+inline thread_local int ThreadPool::workerIndex = -1;
+
+#endif
@@ -0,0 +1,311 @@
+// Headless batch runner: replays recorded order flow for many symbols in parallel.
+//
+// Usage: backtest [--threads N] flow1.csv [flow2.csv ...]
+//
+// Input lines (files are replayed in the order given, lines in file order):
+//   symbol,id,side,type,price,quantity[,stopPrice]
+//   side: B/S   type: L (limit), M (market), S (stop)
+//   e.g. AAPL,17,B,L,101.25,40
+// Blank lines and lines starting with '#' are ignored.
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <climits>
+
+#include "../include/order.hpp"
+#include "../include/OrderBook.hpp"
+#include "../include/ThreadPool.hpp"
+#include "../include/MappedFile.hpp"
+
+using namespace std;
+
+// Files are split at line boundaries into chunks this size for parallel scanning
+const size_t CHUNK_BYTES = 16 << 20;
+
+// Chunks scanned and replayed per batch (times the pool size). Only one batch's
+// line index is alive at a time, so memory stays flat however long the flow is.
+const size_t CHUNKS_PER_WORKER = 2;
+
+// Lines of one symbol inside one chunk (pointers into the mapping)
+struct FlowSlice {
+    const char* end;            // End of the chunk (line parsing bound)
+    vector<const char*> lines;
+};
+
+// One chunk's lines bucketed by symbol
+struct Chunk {
+    const char* begin;
+    const char* end;
+    unordered_map<string_view, FlowSlice> bySymbol;
+    long long malformed = 0;    // Lines with no symbol field
+};
+
+struct BookResult {
+    string symbol;
+    long long orders = 0;
+    long long rejected = 0;     // Malformed lines
+    BookStats stats;
+};
+
+// A book lives across batches; its flow is fed to it one batch at a time
+struct SymbolReplay {
+    unique_ptr<OrderBook> book = make_unique<OrderBook>();
+    BookResult result;
+};
+
+// --- PARSING ---
+// Ids and quantities are int in Order; anything larger is rejected, not truncated
+static bool parseInt(const char*& p, const char* end, long long& out) {
+    if (p == end || *p < '0' || *p > '9') return false;
+    long long v = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        v = v * 10 + (*p++ - '0');
+        if (v > INT_MAX) return false;
+    }
+    out = v;
+    return true;
+}
+
+static bool parsePrice(const char*& p, const char* end, double& out) {
+    long long whole = 0;
+    if (!parseInt(p, end, whole)) return false;
+    double value = (double)whole;
+    if (p < end && *p == '.') {
+        ++p;
+        double scale = 0.1;
+        while (p < end && *p >= '0' && *p <= '9') {
+            value += (*p++ - '0') * scale;
+            scale *= 0.1;
+        }
+    }
+    out = value;
+    return true;
+}
+
+static bool expectComma(const char*& p, const char* end) {
+    if (p == end || *p != ',') return false;
+    ++p;
+    return true;
+}
+
+static const char* lineEnd(const char* p, const char* end) {
+    const char* nl = static_cast<const char*>(memchr(p, '\n', end - p));
+    return nl ? nl : end;
+}
+
+// Parses everything after "symbol," on one line
+static bool parseOrder(const char* p, const char* end, Order& order) {
+    long long id = 0, qty = 0;
+    double price = 0.0, stopPrice = 0.0;
+    if (!parseInt(p, end, id) || !expectComma(p, end)) return false;
+
+    if (p == end || (*p != 'B' && *p != 'S')) return false;
+    Side side = (*p++ == 'B') ? Side::BUY : Side::SELL;
+    if (!expectComma(p, end)) return false;
+
+    if (p == end) return false;
+    OrderType type;
+    switch (*p++) {
+        case 'L': type = OrderType::LIMIT; break;
+        case 'M': type = OrderType::MARKET; break;
+        case 'S': type = OrderType::STOP; break;
+        default: return false;
+    }
+    if (!expectComma(p, end) || !parsePrice(p, end, price)) return false;
+    if (!expectComma(p, end) || !parseInt(p, end, qty) || qty <= 0) return false;
+    if (type == OrderType::STOP) {
+        if (!expectComma(p, end) || !parsePrice(p, end, stopPrice)) return false;
+    }
+    if (p < end && *p == '\r') ++p; // CRLF input
+    if (p != end) return false;      // Trailing fields / garbage
+
+    order = Order((int)id, side, type, price, (int)qty, stopPrice);
+    return true;
+}
+
+// --- PHASE 1: PARTITION BY SYMBOL ---
+static void scanChunk(Chunk& chunk) {
+    const char* p = chunk.begin;
+    while (p < chunk.end) {
+        const char* eol = lineEnd(p, chunk.end);
+        if (p < eol && *p != '#' && *p != '\r') {
+            const char* comma = static_cast<const char*>(memchr(p, ',', eol - p));
+            if (comma) {
+                FlowSlice& slice = chunk.bySymbol[string_view(p, comma - p)];
+                slice.end = chunk.end;
+                slice.lines.push_back(comma + 1);
+            } else {
+                chunk.malformed++;
+            }
+        }
+        p = eol + 1;
+    }
+}
+
+static void splitIntoChunks(const MappedFile& file, vector<Chunk>& chunks) {
+    const char* p = file.begin();
+    while (p < file.end()) {
+        const char* stop = p + min(CHUNK_BYTES, (size_t)(file.end() - p));
+        if (stop < file.end()) stop = lineEnd(stop, file.end()); // Finish the current line
+        chunks.push_back({p, stop, {}});
+        p = stop + 1;
+    }
+}
+
+// --- PHASE 2: REPLAY ONE BOOK'S SHARE OF A BATCH ---
+static void replayBook(const vector<const FlowSlice*>& slices, SymbolReplay& replay) {
+    Order order(0, Side::BUY, OrderType::LIMIT, 0, 0);
+    for (const FlowSlice* slice : slices) {
+        for (const char* line : slice->lines) {
+            if (parseOrder(line, lineEnd(line, slice->end), order)) {
+                replay.book->addOrder(std::move(order));
+                replay.result.orders++;
+            } else {
+                replay.result.rejected++;
+            }
+        }
+    }
+}
+
+void saveStatsToCSV(const vector<BookResult>& results) {
+    ofstream file("backtest_stats.csv");
+    file << "Symbol,Orders,Rejected,Trades,Shares_Traded,VWAP\n";
+    for (auto& r : results) {
+        file << r.symbol << "," << r.orders << "," << r.rejected << "," << r.stats.trades << ","
+             << r.stats.sharesTraded << "," << r.stats.vwap() << "\n";
+    }
+    file.close();
+}
+
+int main(int argc, char** argv) {
+    unsigned numThreads = thread::hardware_concurrency();
+    vector<string> paths;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) numThreads = (unsigned)max(1, atoi(argv[++i]));
+        else paths.push_back(arg);
+    }
+    if (paths.empty()) {
+        cerr << "Usage: " << argv[0] << " [--threads N] flow1.csv [flow2.csv ...]" << endl;
+        return 1;
+    }
+
+    auto start = chrono::steady_clock::now();
+    ThreadPool pool(numThreads);
+
+    // 1. Map every file and split it into line-aligned chunks
+    vector<unique_ptr<MappedFile>> files;
+    vector<Chunk> chunks; // In replay order (file order, then offset)
+    size_t totalBytes = 0;
+    try {
+        for (auto& path : paths) {
+            files.push_back(make_unique<MappedFile>(path));
+            splitIntoChunks(*files.back(), chunks);
+            totalBytes += files.back()->size();
+        }
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    // 2. Stream the chunks through in batches: scan a batch in parallel, then
+    //    replay every symbol's share of it on that symbol's persistent book
+    unordered_map<string_view, SymbolReplay> books;
+    long long unattributed = 0; // Lines with no symbol
+    chrono::duration<double> scanTime{0}, replayTime{0};
+    const size_t batchSize = pool.size() * CHUNKS_PER_WORKER;
+
+    for (size_t first = 0; first < chunks.size(); first += batchSize) {
+        size_t last = min(chunks.size(), first + batchSize);
+        auto scanStart = chrono::steady_clock::now();
+        for (size_t c = first; c < last; ++c) {
+            Chunk* chunk = &chunks[c];
+            pool.submit([chunk] { scanChunk(*chunk); });
+        }
+        pool.wait();
+
+        // Gather each symbol's slices in replay order
+        unordered_map<string_view, vector<const FlowSlice*>> flows;
+        for (size_t c = first; c < last; ++c) {
+            for (auto& entry : chunks[c].bySymbol) flows[entry.first].push_back(&entry.second);
+            unattributed += chunks[c].malformed;
+        }
+        auto replayStart = chrono::steady_clock::now();
+        scanTime += replayStart - scanStart;
+
+        // Largest first: each worker starts on its biggest book and thieves take
+        // the small ones from the back of the queue, which balances the tail
+        vector<pair<size_t, pair<const vector<const FlowSlice*>*, SymbolReplay*>>> work;
+        for (auto& entry : flows) {
+            size_t lines = 0;
+            for (auto* slice : entry.second) lines += slice->lines.size();
+            SymbolReplay& replay = books[entry.first];
+            if (replay.result.symbol.empty()) replay.result.symbol = string(entry.first);
+            work.push_back({lines, {&entry.second, &replay}});
+        }
+        sort(work.begin(), work.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+        for (auto& item : work) {
+            const vector<const FlowSlice*>* slices = item.second.first;
+            SymbolReplay* replay = item.second.second;
+            pool.submit([slices, replay] { replayBook(*slices, *replay); });
+        }
+        pool.wait();
+        replayTime += chrono::steady_clock::now() - replayStart;
+
+        // Drop this batch's line index before scanning the next one
+        for (size_t c = first; c < last; ++c) unordered_map<string_view, FlowSlice>().swap(chunks[c].bySymbol);
+    }
+
+    vector<BookResult> results;
+    results.reserve(books.size());
+    for (auto& entry : books) {
+        entry.second.result.stats = entry.second.book->getStats();
+        results.push_back(std::move(entry.second.result));
+    }
+    auto end = chrono::steady_clock::now();
+
+    // --- REPORT ---
+    sort(results.begin(), results.end(), [](const BookResult& a, const BookResult& b) { return a.symbol < b.symbol; });
+    long long totalOrders = 0, totalRejected = unattributed, totalTrades = 0, totalShares = 0;
+
+    cout << "================================================================" << "\n";
+    cout << " " << left << setw(10) << "SYMBOL" << right << setw(10) << "ORDERS" << setw(10) << "TRADES"
+         << setw(12) << "SHARES" << setw(10) << "VWAP" << setw(10) << "LEVELS" << "\n";
+    cout << "----------------------------------------------------------------" << "\n";
+    for (auto& r : results) {
+        cout << " " << left << setw(10) << r.symbol << right << setw(10) << r.orders << setw(10) << r.stats.trades
+             << setw(12) << r.stats.sharesTraded << setw(10) << fixed << setprecision(2) << r.stats.vwap()
+             << setw(5) << r.stats.bidLevels << "/" << setw(4) << r.stats.askLevels << "\n";
+        totalOrders += r.orders;
+        totalRejected += r.rejected;
+        totalTrades += r.stats.trades;
+        totalShares += r.stats.sharesTraded;
+    }
+
+    double scanSec = scanTime.count();
+    double replaySec = replayTime.count();
+    double totalSec = chrono::duration<double>(end - start).count();
+    cout << "================================================================" << "\n";
+    cout << " Threads        : " << pool.size() << "\n";
+    cout << " Input          : " << files.size() << " files, " << totalBytes / (1 << 20) << " MB, "
+         << results.size() << " books" << "\n";
+    cout << " Orders         : " << totalOrders << " (" << totalRejected << " rejected lines)" << "\n";
+    cout << " Trades         : " << totalTrades << " (" << totalShares << " shares)" << "\n";
+    cout << " Scan time      : " << setprecision(3) << scanSec * 1000 << " ms" << "\n";
+    cout << " Replay time    : " << replaySec * 1000 << " ms" << "\n";
+    cout << " Throughput     : " << setprecision(0) << (totalSec > 0 ? totalOrders / totalSec : 0.0)
+         << " orders/sec" << "\n";
+    cout << "================================================================" << endl;
+
+    saveStatsToCSV(results);
+    return 0;
+}
@@ -7,15 +7,71 @@
 #include <atomic>
 #include <random>
 #include <chrono>
-#include <iomanip>
-#include <cmath>
+#include <memory>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
 
-#include "../include/Order.hpp"
+#include "../include/order.hpp"
 #include "../include/OrderBook.hpp"
 #include "../include/OrderQueue.hpp"
+#include "../include/Affinity.hpp"
+#include "../include/Dashboard.hpp"
 
 using namespace std;
 
+// --- RUNTIME OPTIONS ---
+// Thread placement / scheduling / display options for the simulator
+struct RuntimeConfig {
+    int producerCpu = -1;   // -1 = let the OS scheduler decide
+    int consumerCpu = -1;
+    int displayCpu = -1;
+    int numaNode = -1;      // -1 = node of consumerCpu (when pinned)
+    bool busyPoll = false;  // Spin on the queue instead of sleeping in cv.wait
+    int fifoPriority = 0;   // > 0 = run the matcher under SCHED_FIFO at this priority
+    int refreshHz = 2;      // Dashboard frames per second (1..MAX_REFRESH_HZ)
+    bool dashboard = true;
+};
+
+const int MAX_REFRESH_HZ = 1000;
+
+// --producer-cpu N --consumer-cpu N --display-cpu N --numa-node N --busy-poll --fifo PRIO
+// --refresh-hz N --no-dashboard
+RuntimeConfig parseRuntimeConfig(int argc, char** argv) {
+    RuntimeConfig config;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--busy-poll") config.busyPoll = true;
+        else if (arg == "--producer-cpu" && hasValue) config.producerCpu = atoi(argv[++i]);
+        else if (arg == "--consumer-cpu" && hasValue) config.consumerCpu = atoi(argv[++i]);
+        else if (arg == "--display-cpu" && hasValue) config.displayCpu = atoi(argv[++i]);
+        else if (arg == "--numa-node" && hasValue) config.numaNode = atoi(argv[++i]);
+        else if (arg == "--fifo" && hasValue) config.fifoPriority = atoi(argv[++i]);
+        else if (arg == "--refresh-hz" && hasValue) config.refreshHz = clamp(atoi(argv[++i]), 1, MAX_REFRESH_HZ);
+        else if (arg == "--no-dashboard") config.dashboard = false;
+        else cerr << "Ignoring unknown option: " << arg << endl;
+    }
+    return config;
+}
+
+// A spinning matcher needs a core of its own. Under SCHED_FIFO it would starve the
+// producer and the stdin thread on a shared core until RT throttling kicks in, so
+// that combination is rejected; plain busy-poll on a shared core only gets a warning.
+bool validateRuntimeConfig(const RuntimeConfig& config) {
+    bool dedicatedCore = config.consumerCpu >= 0 && thread::hardware_concurrency() >= 2 &&
+                         config.consumerCpu != config.producerCpu && config.consumerCpu != config.displayCpu;
+    if (!config.busyPoll || dedicatedCore) return true;
+    if (config.fifoPriority > 0) {
+        cerr << "--busy-poll with --fifo needs a dedicated --consumer-cpu (not shared with the producer "
+             << "or display thread, and at least 2 CPUs)" << endl;
+        return false;
+    }
+    cerr << "Warning: --busy-poll without a dedicated --consumer-cpu shares a core; "
+         << "expect worse latency than cv.wait" << endl;
+    return true;
+}
+
 // --- SHARED METRICS ---
 struct SystemMetrics {
     atomic<int> ordersProcessed{0};
@@ -24,7 +80,9 @@ struct SystemMetrics {
 };
 
 vector<long long> latencies;
-OrderBook book;
+vector<long long> wakeupLatencies; // Enqueue -> dequeue (ns): scheduler wakeup cost
+unique_ptr<OrderBook> book;        // Created by the matcher thread (see main)
+atomic<bool> bookReady{false};
 OrderQueue orderQueue;
 atomic<bool> isRunning{true};
 SystemMetrics metrics;
@@ -69,18 +127,33 @@ void simulateMarket() {
 }
 
 // --- CONSUMER ---
-void runMatchingEngine() {
+// busyPoll: spin on poll() instead of sleeping in cv.wait (no wakeup latency,
+// but the consumer's core runs at 100%)
+void runMatchingEngine(bool busyPoll) {
     Order order(0, Side::BUY, OrderType::LIMIT, 0, 0); 
+    OrderQueue::TimePoint enqueuedAt;
     latencies.reserve(100000);
+    wakeupLatencies.reserve(100000);
     long long localTotalLatency = 0;
     int localCount = 0;
 
     while (true) {
-        bool active = orderQueue.pop(order);
-        if (!active) break; 
+        if (busyPoll) {
+            PollResult polled = orderQueue.poll(order, enqueuedAt);
+            if (polled == PollResult::DONE) break;
+            if (polled == PollResult::EMPTY) {
+                cpuRelax();
+                continue;
+            }
+        } else {
+            bool active = orderQueue.pop(order, enqueuedAt);
+            if (!active) break; 
+        }
+        wakeupLatencies.push_back(
+            chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - enqueuedAt).count());
 
         auto start = chrono::high_resolution_clock::now();
-        book.addOrder(std::move(order)); 
+        book->addOrder(std::move(order)); 
         auto end = chrono::high_resolution_clock::now();
         
         auto duration = chrono::duration_cast<chrono::microseconds>(end - start);
@@ -100,102 +173,32 @@ void runMatchingEngine() {
     }
 }
 
-// --- HELPER: ASCII BAR ---
-string drawProgressBar(double percentage) {
-    int width = 10; 
-    string bar = "[";
-    if (percentage > 0) {
-        bar += string(width, ' '); 
-        bar += "|"; 
-        int fill = (int)(percentage * width);
-        bar += string(fill, '#'); 
-        bar += string(width - fill, ' ');
-    } else {
-        int fill = (int)(abs(percentage) * width);
-        bar += string(width - fill, ' ');
-        bar += string(fill, '#');
-        bar += "|"; 
-        bar += string(width, ' ');
-    }
-    bar += "]";
-    return bar;
-}
-
 // --- LIVE DASHBOARD ---
-void displayStats() {
-    int updateCount = 0;
-    while (isRunning) {
-        try {
-            // Only clear screen every 5 updates to reduce flicker
-            if (updateCount % 5 == 0) {
-                cout << "\n\n========================================\n";
-            }
-            
-            double imbalance = book.getImbalance();
-            auto lastTrades = book.getLastTrades();
-            
-            string prediction = "NEUTRAL";
-            string color = "\033[0m"; 
-            if (imbalance > 0.3) { prediction = "BULLISH"; color = "\033[32m"; }
-            else if (imbalance < -0.3) { prediction = "BEARISH"; color = "\033[31m"; }
-
-            // --- HEADER: PERFORMANCE HUD (Feature #4) ---
-            cout << "================================================" << endl;
-            cout << " [SYSTEM STATUS]  Orders: " << setw(5) << metrics.ordersProcessed 
-                 << " | Latency: " << setw(3) << (int)metrics.avgLatency << " us"
-                 << " | Stops: " << setw(3) << book.getPendingStopOrders() << endl;
-            cout << "================================================" << endl;
-            
-            // MARKET SENTIMENT
-            cout << " Signal    : " << color << drawProgressBar(imbalance) 
-                 << " " << prediction << "\033[0m" << endl;
-            cout << "------------------------------------------------" << endl;
-
-            // ORDER BOOK VISUALIZATION
-            vector<OrderBook::LevelInfo> bids, asks;
-            book.getOrderBookSnapshot(bids, asks);
-
-            cout << "   ASKS (Sellers)" << endl;
-            for (auto it = asks.rbegin(); it != asks.rend(); ++it) {
-                cout << "   $" << setw(6) << it->price << " | " << string(it->quantity / 5, '*') << " (" << it->quantity << ")" << endl;
-            }
-
-            cout << "   ---------------------------------" << endl;
+// One lock-free snapshot per frame, formatted into a fixed buffer, one write()
+void displayStats(int refreshHz) {
+    DashboardRenderer renderer;
+    const auto period = chrono::microseconds(1000000 / clamp(refreshHz, 1, MAX_REFRESH_HZ));
+    auto nextFrame = chrono::steady_clock::now();
+    cout << "\033[2J" << flush; // Clear once; frames redraw in place
+    while (!bookReady.load(memory_order_acquire)) this_thread::sleep_for(chrono::milliseconds(1));
+    book->subscribeAnalytics();   // The matcher publishes snapshots only while we read them
 
-            for (auto& level : bids) {
-                cout << "   $" << setw(6) << level.price << " | " << string(level.quantity / 5, '*') << " (" << level.quantity << ")" << endl;
-            }
-            cout << "   BIDS (Buyers)" << endl;
-            cout << "------------------------------------------------" << endl;
-
-            // LAST TRADE (Single Line Only)
-            if (!lastTrades.empty()) {
-                auto t = lastTrades.front(); // Most recent
-                string sideStr = (t.side == Side::BUY) ? "BUY " : "SELL";
-                string sideColor = (t.side == Side::BUY) ? "\033[32m" : "\033[31m";
-                cout << " LAST TRADE: " << sideColor << sideStr << "\033[0m" 
-                     << t.quantity << " @ $" << t.price << endl;
-            } else {
-                cout << " LAST TRADE: (Waiting...)" << endl;
-            }
+    while (isRunning) {
+        AnalyticsSnapshot snap = book->getAnalytics();
+        renderer.render(snap, {metrics.ordersProcessed.load(), metrics.avgLatency.load(), book->getPendingStopOrders()});
+        renderer.flush(STDOUT_FILENO);
 
-            cout << "================================================" << endl;
-            cout << " [ENTER] to Stop and View Full Trade Log" << endl;
-            
-            updateCount++;
-            this_thread::sleep_for(chrono::milliseconds(500)); // Slower updates
-        } catch (...) {
-            // If anything fails, just continue
-            this_thread::sleep_for(chrono::milliseconds(1000));
-        }
+        nextFrame += period;
+        this_thread::sleep_until(nextFrame);
     }
+    book->unsubscribeAnalytics();
 }
 
 void saveLatenciesToCSV() {
     ofstream file("latencies.csv");
-    file << "Order_ID,Latency_Microseconds\n";
+    file << "Order_ID,Latency_Microseconds,Wakeup_Nanoseconds\n";
     for (size_t i = 0; i < latencies.size(); ++i) {
-        file << i << "," << latencies[i] << "\n";
+        file << i << "," << latencies[i] << "," << wakeupLatencies[i] << "\n";
     }
     file.close();
 }
@@ -234,11 +237,53 @@ void printLatencyPercentiles() {
     cout << "========================================" << endl;
 }
 
-int main() {
+// Queue hand-off latency: compare runs with and without --busy-poll
+void printWakeupPercentiles(bool busyPoll) {
+    if (wakeupLatencies.empty()) return;
+    vector<long long> sortedLat = wakeupLatencies;
+    std::sort(sortedLat.begin(), sortedLat.end());
+    size_t total = sortedLat.size();
+
+    cout << "   WAKEUP LATENCY (" << (busyPoll ? "busy-poll" : "cv.wait") << ", ns)" << endl;
+    cout << "----------------------------------------" << endl;
+    cout << " p50 (Median)   : " << sortedLat[(size_t)(total * 0.50)] << " ns" << endl;
+    cout << " p99 (1% Slow)  : " << "\033[33m" << sortedLat[(size_t)(total * 0.99)] << " ns\033[0m" << endl;
+    cout << " p99.9 (Rare)   : " << "\033[31m" << sortedLat[(size_t)(total * 0.999)] << " ns\033[0m" << endl;
+    cout << " Max (Worst)    : " << sortedLat.back() << " ns" << endl;
+    cout << "========================================" << endl;
+}
+
+// Applies CPU pinning (and optionally NUMA / SCHED_FIFO) to the calling thread
+void placeThread(const char* name, int cpu, int numaNode = -1, int fifoPriority = 0) {
+    if (!pinCurrentThread(cpu)) cerr << "[" << name << "] could not pin to CPU " << cpu << endl;
+    if (!preferNumaNode(numaNode)) cerr << "[" << name << "] NUMA binding unavailable, relying on first-touch" << endl;
+    if (!setRealtimePriority(fifoPriority)) cerr << "[" << name << "] SCHED_FIFO refused (needs CAP_SYS_NICE)" << endl;
+}
+
+int main(int argc, char** argv) {
+    RuntimeConfig config = parseRuntimeConfig(argc, argv);
+    if (!validateRuntimeConfig(config)) return 1;
+    int bookNode = (config.numaNode >= 0) ? config.numaNode : numaNodeOfCpu(config.consumerCpu);
+
     cout << "--- Simulation Started ---" << endl;
-    thread producerThread(simulateMarket);
-    thread consumerThread(runMatchingEngine);
-    thread displayThread(displayStats);
+    thread producerThread([&] {
+        placeThread("producer", config.producerCpu);
+        simulateMarket();
+    });
+    // The book is constructed here, after placement, so the matcher first-touches all of
+    // it (analytics ring, snapshot, seqlock words) on its own node, as well as every
+    // level and order it allocates later
+    thread consumerThread([&] {
+        placeThread("consumer", config.consumerCpu, bookNode, config.fifoPriority);
+        book = make_unique<OrderBook>();
+        bookReady.store(true, memory_order_release);
+        runMatchingEngine(config.busyPoll);
+    });
+    thread displayThread([&] {
+        if (!config.dashboard) return;
+        placeThread("display", config.displayCpu);
+        displayStats(config.refreshHz);
+    });
 
     cin.get(); // BLOCKS HERE until you hit Enter
     
@@ -259,8 +304,9 @@ int main() {
     cout << "----------------------------------------" << endl;
     cout << " LAST 5 TRADES:" << endl;
     printLatencyPercentiles();
+    printWakeupPercentiles(config.busyPoll);
     
-    auto history = book.getLastTrades();
+    auto history = book->getLastTrades();
     for (const auto& t : history) {
         string side = (t.side == Side::BUY) ? "BUY " : "SELL";
         cout << "  -> " << side << " " << t.quantity << " @ $" << t.price << endl;